@@ -5,13 +5,22 @@
 
 #include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 
 #include "Shell.h"
 #include "Utils.h"
 
-BuiltinCommands::BuiltinCommands(Shell* shellPtr) : shell(shellPtr) {
+namespace {
+
+// Upper bound on subdirectories one dir listing may add to the path cache,
+// so listing a large directory cannot flush everything else out of it.
+const int kMaxPrimedEntriesPerListing = 32;
+
+}  // namespace
+
+BuiltinCommands::BuiltinCommands(Shell* shellPtr) : shell(shellPtr), input(nullptr) {
     commands["cd"] = [this](const std::vector<std::string>& args) { return cmdCd(args); };
     commands["pwd"] = [this](const std::vector<std::string>& args) { return cmdPwd(args); };
     commands["echo"] = [this](const std::vector<std::string>& args) { return cmdEcho(args); };
@@ -19,6 +28,7 @@ BuiltinCommands::BuiltinCommands(Shell* shellPtr) : shell(shellPtr) {
     commands["exit"] = [this](const std::vector<std::string>& args) { return cmdExit(args); };
     commands["env"] = [this](const std::vector<std::string>& args) { return cmdEnv(args); };
     commands["dir"] = [this](const std::vector<std::string>& args) { return cmdDir(args); };
+    commands["cat"] = [this](const std::vector<std::string>& args) { return cmdCat(args); };
 }
 
 BuiltinCommands::~BuiltinCommands() {}
@@ -27,10 +37,14 @@ bool BuiltinCommands::isBuiltin(const std::string& command) const {
     return commands.find(command) != commands.end();
 }
 
-int BuiltinCommands::execute(const std::string& command, const std::vector<std::string>& args) {
+int BuiltinCommands::execute(const std::string& command, const std::vector<std::string>& args,
+                             const std::string* stdinInput) {
     auto it = commands.find(command);
     if (it != commands.end()) {
-        return it->second(args);
+        input = stdinInput;
+        int result = it->second(args);
+        input = nullptr;
+        return result;
     }
     return 1;
 }
@@ -56,7 +70,7 @@ int BuiltinCommands::cmdCd(const std::vector<std::string>& args) {
         targetDir = shell->getCurrentDirectory() + "\\" + targetDir;
     }
 
-    targetDir = Utils::normalizePath(targetDir);
+    targetDir = Utils::canonicalizePath(targetDir);
 
     if (!Utils::isDirectory(targetDir)) {
         std::cerr << "cd: " + targetDir + ": No such file or directory" << std::endl;
@@ -66,6 +80,7 @@ int BuiltinCommands::cmdCd(const std::vector<std::string>& args) {
     shell->setEnvironmentVariable("OLDPWD", shell->getCurrentDirectory());
 
     if (_chdir(targetDir.c_str()) != 0) {
+        Utils::invalidatePathCache(targetDir);
         std::cerr << "cd: " + targetDir + ": Permission denied" << std::endl;
         return 1;
     }
@@ -118,16 +133,23 @@ int BuiltinCommands::cmdEnv(const std::vector<std::string>& args) {
 }
 
 int BuiltinCommands::cmdDir(const std::vector<std::string>& args) {
-    std::string path = args.empty() ? shell->getCurrentDirectory() : args[0];
-    path = Utils::normalizePath(path);
+    std::string dirPath = args.empty() ? shell->getCurrentDirectory() : args[0];
+    if (!dirPath.empty() && dirPath[0] != '\\' && dirPath[0] != '/' &&
+        !(dirPath.length() > 1 && dirPath[1] == ':')) {
+        dirPath = shell->getCurrentDirectory() + "\\" + dirPath;
+    }
+    dirPath = Utils::canonicalizePath(dirPath);
 
+    std::string path = dirPath;
     if (path.back() != '\\') path += "\\";
+    std::string prefix = path;
     path += "*";
 
     WIN32_FIND_DATAA findFileData;
     HANDLE hFind = FindFirstFileA(path.c_str(), &findFileData);
 
     if (hFind == INVALID_HANDLE_VALUE) {
+        Utils::invalidatePathCache(dirPath);
         std::cerr << "dir: cannot access '"
                   << (args.empty() ? shell->getCurrentDirectory() : args[0]) << "'" << std::endl;
         return 1;
@@ -136,9 +158,21 @@ int BuiltinCommands::cmdDir(const std::vector<std::string>& args) {
     std::cout << "Directory of " << (args.empty() ? shell->getCurrentDirectory() : args[0])
               << "\n\n";
 
+    Utils::primeDirectoryCache(dirPath);
+    int primed = 0;
+
     do {
         if (strcmp(findFileData.cFileName, ".") == 0) continue;
 
+        bool entryIsDir = (findFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        if (entryIsDir && primed < kMaxPrimedEntriesPerListing &&
+            strcmp(findFileData.cFileName, "..") != 0) {
+            // The listing already tells us which entries are directories;
+            // save the follow-up stat when the user cd's into one of them.
+            Utils::primeDirectoryCache(prefix + findFileData.cFileName);
+            ++primed;
+        }
+
         FILETIME localFileTime;
         SYSTEMTIME systemTime;
         FileTimeToLocalFileTime(&findFileData.ftLastWriteTime, &localFileTime);
@@ -148,7 +182,7 @@ int BuiltinCommands::cmdDir(const std::vector<std::string>& args) {
                   << systemTime.wDay << "/" << systemTime.wYear << "  " << std::setw(2)
                   << systemTime.wHour << ":" << std::setw(2) << systemTime.wMinute << " ";
 
-        if (findFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+        if (entryIsDir) {
             std::cout << "    <DIR>          ";
         } else {
             LARGE_INTEGER fileSize;
@@ -164,6 +198,31 @@ int BuiltinCommands::cmdDir(const std::vector<std::string>& args) {
     return 0;
 }
 
+int BuiltinCommands::cmdCat(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        if (!input) {
+            std::cerr << "cat: missing file operand" << std::endl;
+            return 1;
+        }
+        std::cout.write(input->data(), input->size());
+        std::cout.flush();
+        return 0;
+    }
+
+    int status = 0;
+    for (const auto& arg : args) {
+        std::ifstream file(Utils::expandTilde(arg), std::ios::binary);
+        if (!file) {
+            std::cerr << "cat: " + arg + ": No such file or directory" << std::endl;
+            status = 1;
+            continue;
+        }
+        std::cout << file.rdbuf();
+    }
+    std::cout.flush();
+    return status;
+}
+
 int BuiltinCommands::cmdHelp(const std::vector<std::string>& args) {
     if (args.empty()) {
         std::cout << "MyShell - Built-in Commands Help (Windows)\n"
@@ -174,6 +233,7 @@ int BuiltinCommands::cmdHelp(const std::vector<std::string>& args) {
                   << "  echo [text...]     - Display text\n"
                   << "  env                - Display environment variables\n"
                   << "  dir [path]         - List directory contents\n"
+                  << "  cat [file...]      - Print files or here-document input\n"
                   << "  exit [code]        - Exit the shell\n"
                   << "  help [command]     - Show help information\n\n"
                   << "Use 'help <command>' for detailed information about a specific command.\n";
@@ -202,6 +262,11 @@ int BuiltinCommands::cmdHelp(const std::vector<std::string>& args) {
                       << "Usage: dir [path]\n"
                       << "  Lists files and directories in the specified path\n"
                       << "  If no path is specified, lists current directory\n";
+        } else if (cmd == "cat") {
+            std::cout << "cat - Concatenate Files\n"
+                      << "Usage: cat [file...]\n"
+                      << "  Prints each file in turn. With no files, prints the input\n"
+                      << "  given by a here-document (<<EOF, <<-EOF) or here-string (<<<)\n";
         } else if (cmd == "exit") {
             std::cout << "exit - Exit Shell\n"
                       << "Usage: exit [code]\n"
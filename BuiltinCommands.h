@@ -11,6 +11,7 @@ class Shell;
 class BuiltinCommands {
    private:
     Shell* shell;
+    const std::string* input;
     std::unordered_map<std::string, std::function<int(const std::vector<std::string>&)>> commands;
 
     // Command implementations
@@ -22,13 +23,15 @@ class BuiltinCommands {
     int cmdEnv(const std::vector<std::string>& args);
     int cmdCls(const std::vector<std::string>& args);
     int cmdDir(const std::vector<std::string>& args);
+    int cmdCat(const std::vector<std::string>& args);
 
    public:
     BuiltinCommands(Shell* shellPtr);
     ~BuiltinCommands();
 
     bool isBuiltin(const std::string& command) const;
-    int execute(const std::string& command, const std::vector<std::string>& args);
+    int execute(const std::string& command, const std::vector<std::string>& args,
+                const std::string* stdinInput = nullptr);
     void listCommands() const;
 };
 
@@ -5,4 +5,7 @@
 void Command::clear() {
     name.clear();
     arguments.clear();
+    input.clear();
+    hasInput = false;
+    hereDocs.clear();
 }
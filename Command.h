@@ -1,14 +1,34 @@
 #ifndef COMMAND_H
 #define COMMAND_H
 
+#include <deque>
 #include <string>
 #include <vector>
 
+// A here-document whose body has not been fully read yet.
+struct HereDoc {
+    std::string delimiter;
+    bool stripTabs;
+    bool expand;
+    // Only the last redirection on a line supplies stdin; earlier bodies
+    // are read and discarded.
+    bool isInput;
+};
+
 struct Command {
     std::string name;
     std::vector<std::string> arguments;
 
-    Command() {}
+    // Standard input supplied by a here-document or here-string. The body
+    // stays in memory and is handed to builtins directly.
+    std::string input;
+    bool hasInput;
+
+    // Here-documents still waiting for their bodies, in the order their
+    // bodies appear in the input.
+    std::deque<HereDoc> hereDocs;
+
+    Command() : hasInput(false) {}
 
     void clear();
 };
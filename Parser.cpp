@@ -1,5 +1,9 @@
 #include "Parser.h"
 
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
 #include "Utils.h"
 
 Parser::Parser() {}
@@ -12,7 +16,7 @@ Command Parser::parse(const std::string& input) {
 
     if (processedInput.empty()) return cmd;
 
-    std::vector<std::string> tokens = tokenize(processedInput);
+    std::vector<std::string> tokens = tokenize(processedInput, cmd);
     if (tokens.empty()) return cmd;
 
     cmd.name = tokens[0];
@@ -23,12 +27,54 @@ Command Parser::parse(const std::string& input) {
     return cmd;
 }
 
-std::vector<std::string> Parser::tokenize(const std::string& input) {
+bool Parser::needsHereDocBody(const Command& cmd) const { return !cmd.hereDocs.empty(); }
+
+void Parser::addHereDocLine(Command& cmd, const std::string& line) {
+    if (cmd.hereDocs.empty()) return;
+    const HereDoc& doc = cmd.hereDocs.front();
+
+    std::string text = line;
+    if (!text.empty() && text.back() == '\r') text.pop_back();
+
+    if (doc.stripTabs) {
+        size_t start = text.find_first_not_of('\t');
+        text.erase(0, start == std::string::npos ? text.length() : start);
+    }
+
+    if (text == doc.delimiter) {
+        cmd.hereDocs.pop_front();
+        return;
+    }
+
+    if (!doc.isInput) return;
+    cmd.input += doc.expand ? expandVariables(text) : text;
+    cmd.input += '\n';
+}
+
+std::vector<std::string> Parser::tokenize(const std::string& input, Command& cmd) {
     std::vector<std::string> tokens;
     std::string current;
     bool inQuotes = false;
     bool inSingleQuotes = false;
     bool escaped = false;
+    bool quoted = false;
+    bool expanded = false;
+    Redirect pending = Redirect::None;
+
+    // The word following a redirection operator is its target, not an
+    // argument. Quoting it (even as "") or a variable that expands to
+    // nothing still counts as a word.
+    auto finishToken = [&]() {
+        if (pending != Redirect::None && (!current.empty() || quoted || expanded)) {
+            applyRedirect(cmd, pending, current, quoted);
+            pending = Redirect::None;
+        } else if (!current.empty()) {
+            tokens.push_back(current);
+        }
+        current.clear();
+        quoted = false;
+        expanded = false;
+    };
 
     for (size_t i = 0; i < input.length(); ++i) {
         char c = input[i];
@@ -41,32 +87,144 @@ std::vector<std::string> Parser::tokenize(const std::string& input) {
 
         if (c == '\\' && !inSingleQuotes) {
             escaped = true;
+            quoted = true;
             continue;
         }
 
         if (c == '"' && !inSingleQuotes) {
             inQuotes = !inQuotes;
+            quoted = true;
             continue;
         }
 
         if (c == '\'' && !inQuotes) {
             inSingleQuotes = !inSingleQuotes;
+            quoted = true;
+            continue;
+        }
+
+        // Here-string words are expanded as they are read, so single quotes
+        // and backslash escapes only protect the characters they cover.
+        if (c == '$' && !inSingleQuotes && pending == Redirect::HereString) {
+            i = expandVariable(input, i, current);
+            expanded = true;
             continue;
         }
 
         if (!inQuotes && !inSingleQuotes && (c == ' ' || c == '\t')) {
-            if (!current.empty()) {
-                tokens.push_back(current);
-                current.clear();
+            finishToken();
+            continue;
+        }
+
+        if (!inQuotes && !inSingleQuotes && c == '<' && i + 1 < input.length() &&
+            input[i + 1] == '<') {
+            finishToken();
+            if (pending != Redirect::None) {
+                throw std::runtime_error("syntax error near unexpected token `<<'");
             }
+
+            size_t next = i + 2;
+            if (next < input.length() && input[next] == '<') {
+                pending = Redirect::HereString;
+                ++next;
+            } else if (next < input.length() && input[next] == '-') {
+                pending = Redirect::HereDocStripTabs;
+                ++next;
+            } else {
+                pending = Redirect::HereDoc;
+            }
+            i = next - 1;
             continue;
         }
 
         current += c;
     }
 
-    if (!current.empty()) tokens.push_back(current);
+    finishToken();
+    if (pending != Redirect::None) {
+        throw std::runtime_error("syntax error near unexpected token `newline'");
+    }
+
     return tokens;
 }
 
+// A quoted here-document delimiter disables expansion of the body, as in
+// POSIX shells. When a line has several redirections, every here-document
+// body is still read in order, but only the last redirection supplies stdin.
+void Parser::applyRedirect(Command& cmd, Redirect redirect, const std::string& word,
+                           bool quoted) {
+    for (auto& doc : cmd.hereDocs) {
+        doc.isInput = false;
+    }
+    cmd.input.clear();
+    cmd.hasInput = true;
+
+    if (redirect == Redirect::HereString) {
+        cmd.input = word + '\n';
+        return;
+    }
+
+    HereDoc doc;
+    doc.delimiter = word;
+    doc.stripTabs = redirect == Redirect::HereDocStripTabs;
+    doc.expand = !quoted;
+    doc.isInput = true;
+    cmd.hereDocs.push_back(doc);
+}
+
+// Expands $NAME and ${NAME}; "\$" and "\\" yield a literal '$' and '\'.
+std::string Parser::expandVariables(const std::string& str) {
+    std::string result;
+    result.reserve(str.length());
+
+    for (size_t i = 0; i < str.length(); ++i) {
+        char c = str[i];
+
+        if (c == '\\' && i + 1 < str.length() && (str[i + 1] == '$' || str[i + 1] == '\\')) {
+            result += str[++i];
+            continue;
+        }
+
+        if (c == '$') {
+            i = expandVariable(str, i, result);
+            continue;
+        }
+
+        result += c;
+    }
+
+    return result;
+}
+
+// Expands the variable reference starting at the '$' at pos into out and
+// returns the index of its last character. A '$' not followed by a name is
+// kept literally. Shell::setEnvironmentVariable keeps the process
+// environment in sync, so getenv sees shell variables as well as inherited
+// ones.
+size_t Parser::expandVariable(const std::string& str, size_t pos, std::string& out) {
+    size_t start = pos + 1;
+    size_t end = start;
+    bool braced = start < str.length() && str[start] == '{';
+
+    if (braced) {
+        end = str.find('}', start + 1);
+        if (end == std::string::npos) end = start;
+        ++start;
+    } else {
+        while (end < str.length() &&
+               (std::isalnum(static_cast<unsigned char>(str[end])) || str[end] == '_')) {
+            ++end;
+        }
+    }
+
+    if (end <= start) {
+        out += '$';
+        return pos;
+    }
+
+    const char* value = getenv(str.substr(start, end - start).c_str());
+    if (value) out += value;
+    return braced ? end : end - 1;
+}
+
 bool Parser::isEmpty(const std::string& input) { return Utils::trim(input).empty(); }
\ No newline at end of file
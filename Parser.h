@@ -8,13 +8,20 @@
 
 class Parser {
    private:
-    std::vector<std::string> tokenize(const std::string& input);
+    enum class Redirect { None, HereDoc, HereDocStripTabs, HereString };
+
+    std::vector<std::string> tokenize(const std::string& input, Command& cmd);
+    void applyRedirect(Command& cmd, Redirect redirect, const std::string& word, bool quoted);
+    size_t expandVariable(const std::string& str, size_t pos, std::string& out);
 
    public:
     Parser();
     ~Parser();
 
     Command parse(const std::string& input);
+    bool needsHereDocBody(const Command& cmd) const;
+    void addHereDocLine(Command& cmd, const std::string& line);
+    std::string expandVariables(const std::string& str);
     bool isEmpty(const std::string& input);
     std::string trim(const std::string& str);
 };
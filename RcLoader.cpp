@@ -0,0 +1,309 @@
+#include "RcLoader.h"
+
+#include <windows.h>
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "Utils.h"
+
+namespace {
+
+const char kSnapshotMagic[8] = {'M', 'Y', 'S', 'H', 'S', 'N', 'A', 'P'};
+const uint32_t kSnapshotVersion = 3;
+
+// Coarsest mtime granularity we expect (FAT, some network shares), in
+// FILETIME units. An rc file modified this close to the snapshot's write
+// time could be edited again without its mtime changing.
+const uint64_t kMtimeResolution = 2 * 10000000ULL;
+
+bool statFile(const std::string& path, uint64_t& size, uint64_t& mtime) {
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data)) return false;
+    if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) return false;
+
+    size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    mtime = (static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+            data.ftLastWriteTime.dwLowDateTime;
+    return true;
+}
+
+bool readFile(const std::string& path, std::string& content) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    content = ss.str();
+    return true;
+}
+
+// FNV-1a; only needs to detect edits, not resist collisions.
+uint64_t hashContent(const std::string& content) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool isValidName(const std::string& name) {
+    if (name.empty() || !(std::isalpha(static_cast<unsigned char>(name[0])) || name[0] == '_'))
+        return false;
+    for (unsigned char c : name) {
+        if (!std::isalnum(c) && c != '_') return false;
+    }
+    return true;
+}
+
+// Prepares a value for Parser::expandVariables, which turns a doubled
+// backslash into one. Backslashes are doubled here so Windows paths such as
+// \\server\share survive unchanged; only \$ remains an escape. In a literal
+// (single-quoted) value every '$' is escaped as well.
+std::string escapeForExpansion(const std::string& value, bool literal) {
+    std::string escaped;
+    escaped.reserve(value.length());
+    for (size_t i = 0; i < value.length(); ++i) {
+        char c = value[i];
+        if (c == '\\' && !literal && i + 1 < value.length() && value[i + 1] == '$') {
+            escaped += value[i];
+            escaped += value[++i];
+            continue;
+        }
+        if (c == '\\' || (c == '$' && literal)) escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+bool readU32(const char*& p, const char* end, uint32_t& value) {
+    if (end - p < static_cast<ptrdiff_t>(sizeof(value))) return false;
+    std::memcpy(&value, p, sizeof(value));
+    p += sizeof(value);
+    return true;
+}
+
+bool readString(const char*& p, const char* end, std::string& value) {
+    uint32_t len;
+    if (!readU32(p, end, len)) return false;
+    if (static_cast<uint64_t>(end - p) < len) return false;
+    value.assign(p, len);
+    p += len;
+    return true;
+}
+
+// Unmaps the snapshot view on every exit path out of readSnapshot.
+struct MappedView {
+    const char* data;
+
+    explicit MappedView(const char* view) : data(view) {}
+    ~MappedView() {
+        if (data) UnmapViewOfFile(data);
+    }
+    MappedView(const MappedView&) = delete;
+    MappedView& operator=(const MappedView&) = delete;
+};
+
+void writeString(std::ofstream& out, const std::string& value) {
+    uint32_t len = static_cast<uint32_t>(value.length());
+    out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    out.write(value.data(), len);
+}
+
+void printWarnings(const std::vector<std::string>& warnings) {
+    for (const auto& warning : warnings) {
+        std::cerr << warning << std::endl;
+    }
+}
+
+}  // namespace
+
+RcLoader::RcLoader() {}
+
+RcLoader::~RcLoader() {}
+
+bool RcLoader::load(const std::string& rcPath, const std::string& snapshotPath,
+                    Variables& vars) {
+    uint64_t size, mtime;
+    if (!statFile(rcPath, size, mtime)) return false;
+
+    SnapshotHeader header;
+    Variables cached;
+    std::vector<std::string> warnings;
+    bool haveSnapshot = readSnapshot(snapshotPath, header, cached, warnings);
+
+    // Size and mtime alone are trusted only when the snapshot was written
+    // well after the rc file's mtime tick; otherwise confirm by hash.
+    if (haveSnapshot && header.rcSize == size && header.rcMtime == mtime &&
+        header.writtenAt >= mtime + kMtimeResolution) {
+        printWarnings(warnings);
+        vars.swap(cached);
+        return true;
+    }
+
+    std::string content;
+    if (!readFile(rcPath, content)) return false;
+    uint64_t hash = hashContent(content);
+
+    // Unchanged content (touched, or an mtime too recent to trust): refresh
+    // the snapshot's timestamps rather than re-evaluating.
+    if (haveSnapshot && header.rcSize == content.size() && header.rcHash == hash) {
+        header.rcMtime = mtime;
+        writeSnapshot(snapshotPath, header, cached, warnings);
+        printWarnings(warnings);
+        vars.swap(cached);
+        return true;
+    }
+
+    warnings.clear();
+    vars = evaluate(content, warnings);
+
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+    header.version = kSnapshotVersion;
+    header.count = static_cast<uint32_t>(vars.size());
+    header.rcSize = content.size();
+    header.rcMtime = mtime;
+    header.rcHash = hash;
+    writeSnapshot(snapshotPath, header, vars, warnings);
+    printWarnings(warnings);
+    return true;
+}
+
+// Accepts "NAME=value" and "export NAME=value" lines; blank lines and lines
+// starting with '#' are ignored. One layer of matching quotes is stripped.
+// $NAME references are kept unexpanded so the result depends only on the
+// file's content and can be snapshotted; the shell expands them when it
+// applies each variable. Single-quoted values are escaped so they stay
+// literal through that expansion.
+RcLoader::Variables RcLoader::evaluate(const std::string& content,
+                                       std::vector<std::string>& warnings) {
+    Variables vars;
+    std::istringstream in(content);
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        line = Utils::trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        if (line.compare(0, 7, "export ") == 0) line = Utils::trim(line.substr(7));
+
+        size_t eq = line.find('=');
+        std::string name = eq == std::string::npos ? line : Utils::trim(line.substr(0, eq));
+        if (eq == std::string::npos || !isValidName(name)) {
+            warnings.push_back(".myshellrc: line " + std::to_string(lineNumber) +
+                               ": expected NAME=value");
+            continue;
+        }
+
+        std::string value = Utils::trim(line.substr(eq + 1));
+        bool literal = false;
+        if (value.length() >= 2 && (value[0] == '"' || value[0] == '\'') &&
+            value.back() == value[0]) {
+            literal = value[0] == '\'';
+            value = value.substr(1, value.length() - 2);
+        }
+
+        // Later lines may refer to earlier values of the same variable
+        // (PATH=$PATH;...), so every assignment is kept in order.
+        vars.emplace_back(name, escapeForExpansion(value, literal));
+    }
+
+    return vars;
+}
+
+bool RcLoader::readSnapshot(const std::string& path, SnapshotHeader& header, Variables& vars,
+                            std::vector<std::string>& warnings) {
+    HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                               NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize) ||
+        fileSize.QuadPart < static_cast<LONGLONG>(sizeof(SnapshotHeader))) {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(hFile);
+    if (hMapping == NULL) return false;
+
+    MappedView view(static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0)));
+    CloseHandle(hMapping);
+    if (view.data == NULL) return false;
+
+    const char* p = view.data + sizeof(SnapshotHeader);
+    const char* end = view.data + fileSize.QuadPart;
+    std::memcpy(&header, view.data, sizeof(header));
+
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) != 0 ||
+        header.version != kSnapshotVersion) {
+        return false;
+    }
+
+    // The snapshot is only a cache: anything inconsistent with its own size
+    // (a corrupt count, truncated entries, trailing bytes) is rejected so the
+    // caller re-evaluates the rc file instead.
+    uint64_t minBytes = (2 * static_cast<uint64_t>(header.count) + header.warningCount) *
+                        sizeof(uint32_t);
+    if (minBytes > static_cast<uint64_t>(end - p)) return false;
+
+    Variables parsed;
+    parsed.reserve(header.count);
+    for (uint32_t i = 0; i < header.count; ++i) {
+        std::string name, value;
+        if (!readString(p, end, name) || !readString(p, end, value)) return false;
+        parsed.emplace_back(std::move(name), std::move(value));
+    }
+
+    std::vector<std::string> parsedWarnings(header.warningCount);
+    for (auto& warning : parsedWarnings) {
+        if (!readString(p, end, warning)) return false;
+    }
+    if (p != end) return false;
+
+    vars.swap(parsed);
+    warnings.swap(parsedWarnings);
+    return true;
+}
+
+// Written to a temporary file and renamed into place so a concurrent launch
+// never maps a half-written snapshot. Failures are ignored; the next launch
+// simply re-evaluates the rc file.
+void RcLoader::writeSnapshot(const std::string& path, SnapshotHeader& header,
+                             const Variables& vars, const std::vector<std::string>& warnings) {
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    header.writtenAt = (static_cast<uint64_t>(now.dwHighDateTime) << 32) | now.dwLowDateTime;
+    header.warningCount = static_cast<uint32_t>(warnings.size());
+    header.reserved = 0;
+
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& var : vars) {
+            writeString(out, var.first);
+            writeString(out, var.second);
+        }
+        for (const auto& warning : warnings) {
+            writeString(out, warning);
+        }
+        if (!out) {
+            out.close();
+            DeleteFileA(tmpPath.c_str());
+            return;
+        }
+    }
+
+    if (!MoveFileExA(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileA(tmpPath.c_str());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef RCLOADER_H
+#define RCLOADER_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Loads ~/.myshellrc. The evaluated result is written to a binary snapshot
+// next to the rc file; later launches map the snapshot instead of
+// re-evaluating as long as the rc file's size, mtime and content hash match.
+// Warnings about bad rc lines are stored too, so every launch reports them.
+class RcLoader {
+   public:
+    using Variables = std::vector<std::pair<std::string, std::string>>;
+
+   private:
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t count;
+        uint64_t rcSize;
+        uint64_t rcMtime;
+        uint64_t rcHash;
+        uint64_t writtenAt;
+        uint32_t warningCount;
+        uint32_t reserved;
+    };
+
+    Variables evaluate(const std::string& content, std::vector<std::string>& warnings);
+    bool readSnapshot(const std::string& path, SnapshotHeader& header, Variables& vars,
+                      std::vector<std::string>& warnings);
+    void writeSnapshot(const std::string& path, SnapshotHeader& header, const Variables& vars,
+                       const std::vector<std::string>& warnings);
+
+   public:
+    RcLoader();
+    ~RcLoader();
+
+    bool load(const std::string& rcPath, const std::string& snapshotPath, Variables& vars);
+};
+
+#endif
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <iostream>
 
+#include "RcLoader.h"
 #include "Utils.h"
 
 Shell* g_shell = nullptr;
@@ -39,16 +40,36 @@ Shell::Shell() : builtins(this), running(true) {
     currentDirectory = Utils::getCurrentWorkingDirectory();
     SetConsoleCtrlHandler(consoleHandler, TRUE);
 
+    std::string home = Utils::getHomeDirectory();
+
     setEnvironmentVariable("PS1", "myshell> ");
-    setEnvironmentVariable("HOME", Utils::getHomeDirectory());
+    setEnvironmentVariable("HOME", home);
     setEnvironmentVariable("PWD", currentDirectory);
     setEnvironmentVariable("SHELL", "myshell");
     setEnvironmentVariable("USER", getenv("USERNAME") ? getenv("USERNAME") : "unknown");
     setEnvironmentVariable("PATH", getenv("PATH") ? getenv("PATH") : "");
+
+    loadRcFile(home);
 }
 
 Shell::~Shell() { g_shell = nullptr; }
 
+void Shell::loadRcFile(const std::string& home) {
+    std::string rcPath = home + "\\.myshellrc";
+    std::string snapshotPath = home + "\\.myshellrc.snapshot";
+
+    RcLoader loader;
+    RcLoader::Variables vars;
+    if (!loader.load(rcPath, snapshotPath, vars)) return;
+
+    // The snapshot stores values unexpanded, so it depends only on the rc
+    // file. References are resolved here, in order, so each line sees the
+    // variables set by the lines before it.
+    for (const auto& var : vars) {
+        setEnvironmentVariable(var.first, parser.expandVariables(var.second));
+    }
+}
+
 void Shell::run() {
     std::string input;
 
@@ -68,8 +89,24 @@ void Shell::run() {
         try {
             Command command = parser.parse(input);
 
+            while (parser.needsHereDocBody(command)) {
+                std::cout << "> ";
+                std::string line;
+                if (!std::getline(std::cin, line)) {
+                    std::cerr << "\nwarning: here-document delimited by end-of-file (wanted `"
+                              << command.hereDocs.front().delimiter << "')" << std::endl;
+                    break;
+                }
+                parser.addHereDocLine(command, line);
+            }
+
+            // A line holding only redirections (e.g. "<<EOF") has no command
+            // to run once its bodies have been consumed.
+            if (command.name.empty()) continue;
+
             if (builtins.isBuiltin(command.name)) {
-                int result = builtins.execute(command.name, command.arguments);
+                int result = builtins.execute(command.name, command.arguments,
+                                              command.hasInput ? &command.input : nullptr);
                 if (result == -1) running = false;
             } else {
                 std::cerr << "'" << command.name << "': command not found" << std::endl;
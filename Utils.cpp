@@ -5,7 +5,10 @@
 #include <windows.h>
 
 #include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 namespace Utils {
@@ -30,13 +33,107 @@ std::vector<std::string> split(const std::string& str, char delimiter) {
     return tokens;
 }
 
-bool fileExists(const std::string& path) { return _access(path.c_str(), 0) == 0; }
+namespace {
+
+struct CachedAttributes {
+    DWORD attributes;
+    ULONGLONG fetchedAt;
+};
+
+const ULONGLONG kPathCacheTtlMs = 2000;
+const size_t kPathCacheMaxEntries = 256;
+
+std::unordered_map<std::string, CachedAttributes> pathCache;
+
+// Windows paths are usually case-insensitive, so fold case to share entries
+// between "C:\Foo" and "c:\foo". The folded string is only ever a map key;
+// lookups use the canonical path as given, since a directory may have
+// per-directory case sensitivity enabled. Only absolute paths are cached; a
+// relative key would silently change meaning after the next cd.
+std::string pathCacheKey(const std::string& canonical) {
+    std::string key = canonical;
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return key;
+}
+
+bool isCacheablePath(const std::string& key) {
+    return key.length() > 2 &&
+           ((key[1] == ':' && key[2] == '\\') || (key[0] == '\\' && key[1] == '\\'));
+}
+
+// Keeps the cache bounded: expired entries are swept once it fills up, and
+// if everything is still fresh the oldest entry makes room.
+void storeAttributes(const std::string& key, DWORD attributes, ULONGLONG now) {
+    if (pathCache.size() >= kPathCacheMaxEntries && pathCache.find(key) == pathCache.end()) {
+        for (auto it = pathCache.begin(); it != pathCache.end();) {
+            if (now - it->second.fetchedAt >= kPathCacheTtlMs) {
+                it = pathCache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (pathCache.size() >= kPathCacheMaxEntries) {
+            auto oldest = pathCache.begin();
+            for (auto it = pathCache.begin(); it != pathCache.end(); ++it) {
+                if (it->second.fetchedAt < oldest->second.fetchedAt) oldest = it;
+            }
+            pathCache.erase(oldest);
+        }
+    }
+
+    pathCache[key] = {attributes, now};
+}
+
+// Misses are not cached, so a directory created outside the shell is seen
+// on the very next lookup.
+DWORD getCachedAttributes(const std::string& path) {
+    std::string canonical = canonicalizePath(path);
+    if (!isCacheablePath(canonical)) return GetFileAttributesA(path.c_str());
+
+    std::string key = pathCacheKey(canonical);
+
+    ULONGLONG now = GetTickCount64();
+
+    auto it = pathCache.find(key);
+    if (it != pathCache.end() && now - it->second.fetchedAt < kPathCacheTtlMs) {
+        return it->second.attributes;
+    }
+
+    DWORD attributes = GetFileAttributesA(canonical.c_str());
+    if (attributes == INVALID_FILE_ATTRIBUTES) {
+        if (it != pathCache.end()) pathCache.erase(it);
+    } else {
+        storeAttributes(key, attributes, now);
+    }
+    return attributes;
+}
+
+}  // namespace
+
+bool fileExists(const std::string& path) {
+    return getCachedAttributes(path) != INVALID_FILE_ATTRIBUTES;
+}
 
 bool isDirectory(const std::string& path) {
-    DWORD attributes = GetFileAttributesA(path.c_str());
+    DWORD attributes = getCachedAttributes(path);
     return (attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_DIRECTORY);
 }
 
+void primeDirectoryCache(const std::string& path) {
+    std::string canonical = canonicalizePath(path);
+    if (!isCacheablePath(canonical)) return;
+
+    storeAttributes(pathCacheKey(canonical), FILE_ATTRIBUTE_DIRECTORY, GetTickCount64());
+}
+
+void invalidatePathCache(const std::string& path) {
+    pathCache.erase(pathCacheKey(canonicalizePath(path)));
+}
+
+void clearPathCache() { pathCache.clear(); }
+
 std::string expandTilde(const std::string& path) {
     if (path.empty() || path[0] != '~') return path;
 
@@ -86,4 +183,76 @@ std::string normalizePath(const std::string& path) {
     return normalized;
 }
 
+// Resolves ".", ".." and repeated or trailing separators without touching
+// the filesystem. Drive ("C:\\"), UNC ("\\\\server\\share\\") and rooted
+// prefixes are preserved; ".." never climbs above them. Relative paths keep
+// leading ".." segments since there is nothing to resolve them against.
+std::string canonicalizePath(const std::string& path) {
+    const size_t n = path.length();
+    if (n >= MAX_PATH) return normalizePath(path);
+
+    auto isSep = [](char c) { return c == '\\' || c == '/'; };
+
+    char buf[MAX_PATH + 4];
+    size_t segStarts[MAX_PATH];
+    size_t len = 0;
+    size_t depth = 0;
+    size_t pinned = 0;
+    size_t i = 0;
+    bool rooted = false;
+
+    if (n >= 2 && isSep(path[0]) && isSep(path[1])) {
+        buf[len++] = '\\';
+        buf[len++] = '\\';
+        i = 2;
+        for (int part = 0; part < 2; ++part) {
+            while (i < n && isSep(path[i])) ++i;
+            while (i < n && !isSep(path[i])) buf[len++] = path[i++];
+            buf[len++] = '\\';
+        }
+        rooted = true;
+    } else {
+        if (n >= 2 && path[1] == ':') {
+            buf[len++] = path[0];
+            buf[len++] = ':';
+            i = 2;
+        }
+        if (i < n && isSep(path[i])) {
+            buf[len++] = '\\';
+            rooted = true;
+        }
+    }
+
+    const size_t rootLen = len;
+
+    while (i < n) {
+        while (i < n && isSep(path[i])) ++i;
+        size_t start = i;
+        while (i < n && !isSep(path[i])) ++i;
+        size_t segLen = i - start;
+
+        if (segLen == 0 || (segLen == 1 && path[start] == '.')) continue;
+
+        bool dotDot = segLen == 2 && path[start] == '.' && path[start + 1] == '.';
+        if (dotDot) {
+            if (depth > pinned) {
+                len = segStarts[--depth];
+                continue;
+            }
+            if (rooted) continue;
+            ++pinned;
+        }
+
+        if (len > rootLen && buf[len - 1] != '\\') buf[len++] = '\\';
+        segStarts[depth++] = len;
+        std::memcpy(buf + len, path.data() + start, segLen);
+        len += segLen;
+    }
+
+    if (len > rootLen && buf[len - 1] == '\\') --len;
+    if (len == 0) return ".";
+
+    return std::string(buf, len);
+}
+
 }  
\ No newline at end of file
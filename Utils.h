@@ -11,6 +11,7 @@ std::string trim(const std::string& str);
 std::vector<std::string> split(const std::string& str, char delimiter);
 bool endsWith(const std::string& str, const std::string& suffix);
 std::string normalizePath(const std::string& path);
+std::string canonicalizePath(const std::string& path);
 
 // File and directory functions
 bool fileExists(const std::string& path);
@@ -19,6 +20,14 @@ std::string expandTilde(const std::string& path);
 std::string getHomeDirectory();
 std::string getCurrentWorkingDirectory();
 
+// Small per-session attribute cache backing fileExists/isDirectory.
+// Entries expire after a short TTL; callers that change the filesystem
+// (or learn from a directory listing that a path is a directory) keep it
+// coherent.
+void primeDirectoryCache(const std::string& path);
+void invalidatePathCache(const std::string& path);
+void clearPathCache();
+
 // Color constants for output
 namespace Colors {
 extern const std::string RESET;
@@ -17,6 +17,8 @@ class Shell {
     Parser parser;
     bool running;
 
+    void loadRcFile(const std::string& home);
+
    public:
     Shell();
     ~Shell();